@@ -1,5 +1,11 @@
 
 #include "xresource_mgr_unit_test_example01.h"
+#include <filesystem>
+#include <fstream>
+
+#if !defined(_WIN32)
+    #include <sys/resource.h>
+#endif
 
 
 
@@ -90,5 +96,240 @@ int main()
     // We are going to fake call this function pretending a frame has pass 
     Mgr.OnEndFrameDelegate();
 
+    //
+    // Meshes use the death march plus the background destruction thread
+    //
+    std::array<xrsc::mesh, 10> ListOfMeshes;
+    for (auto& E : ListOfMeshes)
+    {
+        E.m_Instance.GenerateGUID();
+        auto pMesh = Mgr.getResource(E);
+        assert(pMesh && pMesh->m_Vertices.back() == 22.0f);
+    }
+
+    for (auto& E : ListOfMeshes) Mgr.ReleaseRef(E);
+    assert(Mgr.getResourceCount() == 0);
+
+    // While in the death march the flush must not touch them
+    Mgr.FlushBackgroundDestruction();
+    assert(xresource::loader<xrsc::mesh_type_guid_v>::s_nDestroyedInWorker == 0);
+
+    // Let the death march expire so the meshes get sent to the worker, then wait for all of them
+    Mgr.OnEndFrameDelegate();
+    Mgr.OnEndFrameDelegate();
+    Mgr.FlushBackgroundDestruction();
+    assert(xresource::loader<xrsc::mesh_type_guid_v>::s_nDestroyedInWorker == static_cast<int>(ListOfMeshes.size()));
+
+    //
+    // At shutdown we can drain the death march without waiting for the frames
+    //
+    {
+        std::array<xrsc::mesh, 10> ListOfDrainMeshes;
+        for (auto& E : ListOfDrainMeshes)
+        {
+            E.m_Instance.GenerateGUID();
+            auto pMesh = Mgr.getResource(E);
+            assert(pMesh);
+        }
+        for (auto& E : ListOfDrainMeshes) Mgr.ReleaseRef(E);
+
+        Mgr.DrainDeathMarch();
+        assert(xresource::loader<xrsc::mesh_type_guid_v>::s_nDestroyedInWorker == static_cast<int>(ListOfMeshes.size() + ListOfDrainMeshes.size()));
+    }
+
+    //
+    // Build resource paths without allocating
+    //
+    {
+        xresource::full_guid Guid;
+        Guid.m_Type             = xrsc::mesh_type_guid_v;
+        Guid.m_Instance.m_Value = 0x123456789ABCDEF1ull;
+        Mgr.setRootPath(L"Assets");
+
+        std::array<char, 256> Buffer;
+        auto Length = Mgr.getResourcePath(Buffer, Guid);
+    #if defined(_WIN32)
+        assert(std::string_view(Buffer.data(), Length) == "Assets\\Mesh\\F1\\DE\\123456789ABCDEF1");
+    #else
+        assert(std::string_view(Buffer.data(), Length) == "Assets/Mesh/F1/DE/123456789ABCDEF1");
+    #endif
+
+        // Without a root path the path is relative
+        Mgr.setRootPath(L"");
+        Length = Mgr.getResourcePath(Buffer, Guid);
+    #if defined(_WIN32)
+        assert(std::string_view(Buffer.data(), Length) == "Mesh\\F1\\DE\\123456789ABCDEF1");
+    #else
+        assert(std::string_view(Buffer.data(), Length) == "Mesh/F1/DE/123456789ABCDEF1");
+    #endif
+
+        // When the buffer is too small we get nothing back
+        std::array<char, 8> SmallBuffer;
+        assert(Mgr.getResourcePath(SmallBuffer, Guid) == 0);
+    }
+
+    //
+    // Weak references do not keep the resource alive
+    //
+    {
+        xrsc::texture Texture;
+        Texture.m_Instance.GenerateGUID();
+
+        auto pTexture = Mgr.getResource(Texture);
+        auto Weak     = Mgr.getWeakRef(Texture);
+        assert(Mgr.isAlive(Weak));
+
+        // Upgrade to a strong reference
+        xrsc::texture Strong;
+        auto pLocked = Mgr.LockWeakRef(Strong, Weak);
+        assert(pLocked == pTexture);
+        Mgr.ReleaseRef(Strong);
+        Mgr.ReleaseRef(Texture);
+
+        // The resource is gone so the weak reference should fail
+        assert(Mgr.isAlive(Weak) == false);
+        pLocked = Mgr.LockWeakRef(Strong, Weak);
+        assert(pLocked == nullptr);
+        assert(Mgr.getResourceCount() == 0);
+    }
+
+    //
+    // Progressive resources, we get level 0 right away and the rest are streamed
+    //
+    {
+        xrsc::mip_texture Texture;
+        Texture.m_Instance.GenerateGUID();
+
+        auto pTexture = Mgr.getResource(Texture);
+        auto Weak     = Mgr.getWeakRef(Texture);
+        assert(pTexture && pTexture->m_Mips.size() == 1);
+
+        // Keep using it while the frames go by... all the levels should come in and stay
+        // The handle already holds the pointer so getResource does not track it, we tell the manager using the weak reference
+        Mgr.setStreamingIdleFrames(2);
+        for (int i = 0; i < 20; ++i)
+        {
+            auto pUsed = Mgr.getResource(Texture);
+            assert(pUsed == pTexture);
+            Mgr.MarkUsed(Weak);
+            Mgr.OnEndFrameDelegate();
+            Mgr.FlushStreaming();
+        }
+        assert(Mgr.getResidentLevels(Weak) == xresource::loader<xrsc::mip_texture_type_guid_v>::mip_count_v);
+        assert(Mgr.getStreamingMemory() == 64 + 256 + 1024);
+
+        // A small budget should drop the high levels
+        Mgr.setStreamingBudget(256 + 64);
+        Mgr.OnEndFrameDelegate();
+        assert(Mgr.getResidentLevels(Weak) == 3);
+
+        // If no one uses it then it should go back to level 0
+        for (int i = 0; i < 8; ++i) Mgr.OnEndFrameDelegate();
+        assert(Mgr.getResidentLevels(Weak) == 1 && pTexture->m_Mips.size() == 1);
+        assert(Mgr.getStreamingMemory() == 0);
+
+        Mgr.ReleaseRef(Texture);
+        assert(Mgr.getResourceCount() == 0);
+        Mgr.setStreamingBudget(~std::size_t{0});
+
+        // Releasing it while a level is in flight makes it go away for the user right away
+        pTexture = Mgr.getResource(Texture);
+        Weak     = Mgr.getWeakRef(Texture);
+        Mgr.OnEndFrameDelegate();
+        Mgr.ReleaseRef(Texture);
+        assert(Mgr.getResourceCount() == 0 && Mgr.isAlive(Weak) == false);
+
+        // ... and the data is destroyed once the level arrives, the level is discarded rather than committed
+        Mgr.FlushStreaming();
+        assert(Mgr.getStreamingMemory() == 0);
+        assert(xresource::loader<xrsc::mip_texture_type_guid_v>::s_nDiscarded == 1);
+    }
+
+    //
+    // Relocatable blobs, first the tool side creates the file...
+    //
+    {
+        auto RootPath = std::filesystem::temp_directory_path() / "xresource_mgr_unit_test";
+        Mgr.setRootPath(RootPath.wstring());
+
+        xresource::blob_builder Builder;
+        const auto Root = Builder.Allocate<xgpu::animation>();
+        const auto Keys = Builder.Allocate<float>(4);
+        Builder.get<xgpu::animation>(Root).m_nKeys = 4;
+        for (int i = 0; i < 4; ++i) Builder.get<float>(Keys + i * sizeof(float)) = static_cast<float>(i);
+        Builder.LinkPointer<float>(Root + offsetof(xgpu::animation, m_pKeys), Keys, 4);
+        const auto File = Builder.Build();
+
+        // Corrupt pointers (misaligned, or pointing past the end of the data) must be rejected
+        {
+            // Blobs must be in memory aligned to blob_alignment_v (same as LoadBlob does)
+            auto AlignedCopy = [&]( std::uint64_t KeysOffset )
+            {
+                auto pCopy = static_cast<std::byte*>(::operator new(File.size(), std::align_val_t{ xresource::blob_alignment_v }));
+                std::memcpy(pCopy, File.data(), File.size());
+                std::memcpy(pCopy + sizeof(xresource::blob_header) + Root + offsetof(xgpu::animation, m_pKeys), &KeysOffset, sizeof(KeysOffset));
+                return std::unique_ptr<std::byte, void(*)(std::byte*)>( pCopy, [](std::byte* p){ ::operator delete(p, std::align_val_t{ xresource::blob_alignment_v }); } );
+            };
+
+            for (std::uint64_t BadOffset : { std::uint64_t{Keys} + 1, std::uint64_t{Keys} + 8 })
+            {
+                auto Corrupt = AlignedCopy(BadOffset);
+                assert(xresource::RelocateBlob({ Corrupt.get(), File.size() }) == nullptr);
+            }
+
+            auto Good = AlignedCopy(Keys);
+            assert(xresource::RelocateBlob({ Good.get(), File.size() }) != nullptr);
+        }
+
+        // Many more animations than file handles we will allow (so they land in many XX/YY buckets)
+        std::vector<xrsc::animation> ListOfAnimations(300);
+        for (auto& Animation : ListOfAnimations)
+        {
+            Animation.m_Instance.GenerateGUID();
+
+            std::array<char, 512> Path;
+            const auto PathLength = Mgr.getResourcePath(Path, Animation);
+            assert(PathLength > 0);
+            std::filesystem::create_directories(std::filesystem::path(Path.data()).parent_path());
+            std::ofstream(Path.data(), std::ios::binary).write(reinterpret_cast<const char*>(File.data()), File.size());
+        }
+
+    #if !defined(_WIN32)
+        // The manager must not keep a handle per bucket
+        rlimit OldLimit;
+        getrlimit(RLIMIT_NOFILE, &OldLimit);
+        rlimit NewLimit = OldLimit;
+        NewLimit.rlim_cur = 64;
+        setrlimit(RLIMIT_NOFILE, &NewLimit);
+    #endif
+
+        // ... then the runtime loads them with one read and uses them as is
+        for (auto& Animation : ListOfAnimations)
+        {
+            auto pAnimation = Mgr.getResource(Animation);
+            assert(pAnimation && pAnimation->m_nKeys == 4 && pAnimation->m_pKeys[3] == 3.0f);
+        }
+
+    #if !defined(_WIN32)
+        setrlimit(RLIMIT_NOFILE, &OldLimit);
+
+        // A resource in the same XX/YY bucket must reuse the cached bucket handle
+        {
+            const xresource::full_guid  Original   = Mgr.getFullGuid(ListOfAnimations[0]);
+            xresource::full_guid        SameBucket = Original;
+            SameBucket.m_Instance.m_Value += 0x10000;
+
+            const int FD = Mgr.getResourceDirectory(SameBucket);
+            assert(FD != -1 && Mgr.getResourceDirectory(Original) == FD);
+        }
+    #endif
+
+        for (auto& Animation : ListOfAnimations) Mgr.ReleaseRef(Animation);
+        assert(Mgr.getResourceCount() == 0);
+
+        Mgr.CloseDirectoryCache();
+        std::filesystem::remove_all(RootPath);
+    }
+
     return 0;
 }
\ No newline at end of file
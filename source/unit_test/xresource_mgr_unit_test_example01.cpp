@@ -40,3 +40,86 @@ void xresource::loader< xrsc::texture_type_guid_v >::Destroy(xresource::mgr& Mgr
     // In openGL we would need to unregister our data and such before actually deleting our structure.
     delete &Data;
 }
+
+//--------------------------------------------------------------------------
+
+xgpu::mesh* xresource::loader< xrsc::mesh_type_guid_v >::Load(xresource::mgr& Mgr, const full_guid& GUID)
+{
+    // Pretend we loaded a big mesh
+    auto OurData = std::make_unique<xgpu::mesh>();
+    OurData->m_Vertices.resize(64 * 1024, 22.0f);
+    return OurData.release();
+}
+
+//--------------------------------------------------------------------------
+// This gets called from the background destruction thread
+// so it must not touch anything that the main thread may be using (including the resource manager)
+void xresource::loader< xrsc::mesh_type_guid_v >::Destroy(xresource::mgr& Mgr, data_type&& Data, const full_guid& GUID)
+{
+    if (std::this_thread::get_id() != s_MainThreadID) s_nDestroyedInWorker++;
+    delete &Data;
+}
+
+//--------------------------------------------------------------------------
+
+xgpu::mip_texture* xresource::loader< xrsc::mip_texture_type_guid_v >::Load(xresource::mgr& Mgr, const full_guid& GUID)
+{
+    // Only the smallest mip is loaded here so the resource can be used right away
+    auto OurData = std::make_unique<xgpu::mip_texture>();
+    OurData->m_Mips.emplace_back(getLevelSize(*OurData, 0), std::uint8_t{22});
+    return OurData.release();
+}
+
+//--------------------------------------------------------------------------
+
+void xresource::loader< xrsc::mip_texture_type_guid_v >::Destroy(xresource::mgr& Mgr, data_type&& Data, const full_guid& GUID)
+{
+    delete &Data;
+}
+
+//--------------------------------------------------------------------------
+
+int xresource::loader< xrsc::mip_texture_type_guid_v >::getLevelCount(const data_type& Data)
+{
+    return mip_count_v;
+}
+
+//--------------------------------------------------------------------------
+// Each level is 4 times bigger than the previous one
+std::size_t xresource::loader< xrsc::mip_texture_type_guid_v >::getLevelSize(const data_type& Data, int Level)
+{
+    return std::size_t{16} << (2 * Level);
+}
+
+//--------------------------------------------------------------------------
+// Called from the streaming thread, we must not touch Data here
+void* xresource::loader< xrsc::mip_texture_type_guid_v >::StreamLevel(xresource::mgr& Mgr, const data_type& Data, int Level, const full_guid& GUID)
+{
+    return new std::vector<std::uint8_t>(getLevelSize(Data, Level), std::uint8_t{22});
+}
+
+//--------------------------------------------------------------------------
+
+void xresource::loader< xrsc::mip_texture_type_guid_v >::CommitLevel(xresource::mgr& Mgr, data_type& Data, int Level, void* pStaging, const full_guid& GUID)
+{
+    std::unique_ptr<std::vector<std::uint8_t>> pMip{ static_cast<std::vector<std::uint8_t>*>(pStaging) };
+    assert(static_cast<int>(Data.m_Mips.size()) == Level);
+    Data.m_Mips.push_back(std::move(*pMip));
+}
+
+//--------------------------------------------------------------------------
+
+void xresource::loader< xrsc::mip_texture_type_guid_v >::DropLevel(xresource::mgr& Mgr, data_type& Data, int Level, const full_guid& GUID)
+{
+    assert(static_cast<int>(Data.m_Mips.size()) == Level + 1);
+    Data.m_Mips.pop_back();
+}
+
+//--------------------------------------------------------------------------
+
+// The resource is going away so the level is freed without touching Data
+void xresource::loader< xrsc::mip_texture_type_guid_v >::DiscardLevel(xresource::mgr& Mgr, data_type& Data, int Level, void* pStaging, const full_guid& GUID)
+{
+    delete static_cast<std::vector<std::uint8_t>*>(pStaging);
+    s_nDiscarded++;
+}
@@ -1,4 +1,5 @@
 #include "source/xresource_mgr.h"
+#include <atomic>
 
 //
 // Put all the resource types here...
@@ -11,6 +12,24 @@ struct xgpu
     {
         int m_X;
     };
+
+    struct mesh
+    {
+        std::vector<float> m_Vertices;
+    };
+
+    // This is a relocatable blob, so it is used directly as it comes from the file
+    struct animation
+    {
+        std::uint32_t                   m_nKeys;
+        xresource::blob_ptr<float>      m_pKeys;
+    };
+
+    // A texture with mips, the smallest mip is level 0
+    struct mip_texture
+    {
+        std::vector<std::vector<std::uint8_t>> m_Mips;
+    };
 };
 
 //
@@ -31,6 +50,18 @@ namespace xrsc
 
     // Now we define the actual handle for our textures... we will reference all our textures using this handle
     using                           texture             = xresource::def_guid<texture_type_guid_v>;
+
+    // Meshes are heavy to free so we will use them to show the background destruction
+    inline static constexpr auto    mesh_type_guid_v    = xresource::type_guid(xresource::guid_generator::Instance64FromString("mesh"));
+    using                           mesh                = xresource::def_guid<mesh_type_guid_v>;
+
+    // Animations are stored as relocatable blobs
+    inline static constexpr auto    animation_type_guid_v = xresource::type_guid(xresource::guid_generator::Instance64FromString("animation"));
+    using                           animation           = xresource::def_guid<animation_type_guid_v>;
+
+    // Mip textures are streamed one level at a time
+    inline static constexpr auto    mip_texture_type_guid_v = xresource::type_guid(xresource::guid_generator::Instance64FromString("mip_texture"));
+    using                           mip_texture         = xresource::def_guid<mip_texture_type_guid_v>;
 }
 
 // We define our loader here...
@@ -51,3 +82,60 @@ struct xresource::loader< xrsc::texture_type_guid_v >
 // Officially register the loader like this...
 inline static xresource::loader_registration<xrsc::texture_type_guid_v> texture_loader;
 
+// A loader which hands its dead resources to the background destruction thread
+template<>
+struct xresource::loader< xrsc::mesh_type_guid_v >
+{
+    //--- Expected static parameters ---
+    constexpr static inline auto        type_name_v                     = L"Mesh";
+    using                               data_type                       = xgpu::mesh;
+    constexpr static inline auto        use_death_march_v               = true;                     // Background destruction only applies to death march entries
+    constexpr static inline auto        use_background_destruction_v    = true;                     // Once the death march expires the Destroy will be call from a worker thread
+
+    static data_type*                   Load        (xresource::mgr& Mgr, const full_guid& GUID);
+    static void                         Destroy     (xresource::mgr& Mgr, data_type&& Data, const full_guid& GUID);
+
+    // Used by the unit test to make sure the meshes were destroyed by the worker thread
+    inline static const std::thread::id s_MainThreadID          = std::this_thread::get_id();
+    inline static std::atomic<int>      s_nDestroyedInWorker    = 0;
+};
+
+inline static xresource::loader_registration<xrsc::mesh_type_guid_v> mesh_loader;
+
+// Blob loaders get the Load and Destroy for free
+template<>
+struct xresource::loader< xrsc::animation_type_guid_v > : xresource::blob_loader<xgpu::animation>
+{
+    //--- Expected static parameters ---
+    constexpr static inline auto        type_name_v         = L"Animation";
+    constexpr static inline auto        use_death_march_v   = false;
+};
+
+inline static xresource::loader_registration<xrsc::animation_type_guid_v> animation_loader;
+
+// Progressive loader, Load only brings the smallest mip and the rest are streamed by the manager
+template<>
+struct xresource::loader< xrsc::mip_texture_type_guid_v >
+{
+    //--- Expected static parameters ---
+    constexpr static inline auto        type_name_v         = L"MipTexture";
+    using                               data_type           = xgpu::mip_texture;
+    constexpr static inline auto        use_death_march_v   = false;
+    constexpr static inline auto        use_progressive_v   = true;
+    constexpr static inline int         mip_count_v         = 4;
+
+    static data_type*                   Load        (xresource::mgr& Mgr, const full_guid& GUID);
+    static void                         Destroy     (xresource::mgr& Mgr, data_type&& Data, const full_guid& GUID);
+
+    //--- Progressive functions ---
+    static int                          getLevelCount   (const data_type& Data);
+    static std::size_t                  getLevelSize    (const data_type& Data, int Level);
+    static void*                        StreamLevel     (xresource::mgr& Mgr, const data_type& Data, int Level, const full_guid& GUID);
+    static void                         CommitLevel     (xresource::mgr& Mgr, data_type& Data, int Level, void* pStaging, const full_guid& GUID);
+    static void                         DropLevel       (xresource::mgr& Mgr, data_type& Data, int Level, const full_guid& GUID);
+    static void                         DiscardLevel    (xresource::mgr& Mgr, data_type& Data, int Level, void* pStaging, const full_guid& GUID);
+
+    inline static int                   s_nDiscarded    = 0;
+};
+
+inline static xresource::loader_registration<xrsc::mip_texture_type_guid_v> mip_texture_loader;
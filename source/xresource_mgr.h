@@ -5,6 +5,24 @@
 #include <cassert>
 #include <unordered_map>
 #include <array>
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <span>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/stat.h>
+#endif
 #include "dependencies/xresource_guid/source/xresource_guid.h"
 
 //----------------------------------------------------------------------------------
@@ -18,11 +36,32 @@
 //      //--- Expected static parameters ---
 //      constexpr static inline auto         type_name_v        = "Texture";            // Name of the type used in the resource path
 //      constexpr static inline auto         use_death_march_v  = true;                 // Will wait at least 1 frame before releasing the resource
+//      constexpr static inline auto         use_background_destruction_v = true;       // (Optional) Expired death march entries are destroyed in a worker thread
+//      constexpr static inline auto         use_progressive_v  = true;                 // (Optional) The resource has quality levels (mips, LODs) which are streamed
 //      using                                data_type          = xgpu::texture         // This is the actual data type of the runtime resource itself...
 //
 //      static data_type*                    Load   ( xresource::mgr& Mgr,                    const full_guid& GUID );
 //      static void                          Destroy( xresource::mgr& Mgr, data_type& Data,   const full_guid& GUID );
 // };
+//
+// NOTE: When use_background_destruction_v is true Destroy runs in the destruction thread. The manager is not thread safe
+//       so Destroy must not call it (ReleaseRef, getResource, CloneRef, ...). If your resource holds references to other
+//       resources release them before (or turn off the background destruction for that type). Debug builds will assert.
+//
+//      //--- Only needed when use_progressive_v is true ---
+//      // Load only needs to make level 0 (the lowest quality) resident, the rest are streamed in the background
+//      static int                           getLevelCount  ( const data_type& Data );
+//      static std::size_t                   getLevelSize   ( const data_type& Data, int Level );                   // Memory used by the level (for the budget)
+//      static void*                         StreamLevel    ( xresource::mgr& Mgr, const data_type& Data, int Level, const full_guid& GUID );   // Streaming thread, must not modify Data. Returns the staging data or nullptr on failure
+//      static void                          CommitLevel    ( xresource::mgr& Mgr, data_type& Data, int Level, void* pStaging, const full_guid& GUID );  // Main thread, takes ownership of pStaging
+//      static void                          DropLevel      ( xresource::mgr& Mgr, data_type& Data, int Level, const full_guid& GUID );  // Main thread, always the highest resident level
+//      static void                          DiscardLevel   ( xresource::mgr& Mgr, data_type& Data, int Level, void* pStaging, const full_guid& GUID );  // Optional, main thread, frees a level that will never be committed (defaults to CommitLevel)
+//
+// NOTE: StreamLevel runs in the streaming thread. The only manager functions it may call are getResourcePath (the buffer
+//       version), getTypeDirectory, OpenResource and LoadBlob/DestroyBlob. Every other function is main thread only.
+//       Usage (which decides which levels stay resident) is recorded when getResource resolves a guid, by LockWeakRef
+//       and by MarkUsed. A reference which already holds the pointer is not tracked, call MarkUsed( WeakRef ) every frame.
+//
 // After you have define the loader type you need to register it, like this...
 // inline static xresource::loader_registration<texture_guid.m_Type> UniqueName;
 //
@@ -56,12 +95,149 @@ namespace xresource
             [[nodiscard]]   constexpr virtual std::wstring_view       getTypeName         ( void )                                                    const     = 0;
             [[nodiscard]]   constexpr virtual type_guid               getTypeGuid         ( void )                                                    const     = 0;
             [[nodiscard]]   constexpr virtual bool                    hasDeathmarchOn     ( void )                                                    const     = 0;
+            [[nodiscard]]   constexpr virtual bool                    hasBackgroundDestructionOn( void )                                              const     = 0;
+            [[nodiscard]]   constexpr virtual bool                    hasProgressiveOn    ( void )                                                    const     = 0;
+            [[nodiscard]]   constexpr virtual int                     getLevelCount       ( const void* pData )                                       const     = 0;
+            [[nodiscard]]   constexpr virtual std::size_t             getLevelSize        ( const void* pData, int Level )                            const     = 0;
+            [[nodiscard]]   constexpr virtual void*                   StreamLevel         ( xresource::mgr& Mgr, const void* pData, int Level, const full_guid& GUID ) const = 0;
+                            constexpr virtual void                    CommitLevel         ( xresource::mgr& Mgr, void* pData, int Level, void* pStaging, const full_guid& GUID ) const = 0;
+                            constexpr virtual void                    DropLevel           ( xresource::mgr& Mgr, void* pData, int Level, const full_guid& GUID ) const = 0;
+                            constexpr virtual void                    DiscardLevel        ( xresource::mgr& Mgr, void* pData, int Level, void* pStaging, const full_guid& GUID ) const = 0;
+        };
+
+        //
+        // Single worker thread which consumes jobs from a bounded ring buffer.
+        // When the queue is full Push will block the caller until there is space (back-pressure)
+        //
+        template< typename T_JOB >
+        struct bounded_worker
+        {
+            using process_fn = void( void* pContext, T_JOB& Job );
+
+           ~bounded_worker( void ) noexcept
+            {
+                Stop();
+            }
+
+            void Start( std::size_t Capacity, process_fn* pProcess, void* pContext ) noexcept
+            {
+                assert( m_Thread.joinable() == false );
+                assert( Capacity > 0 && pProcess );
+
+                m_Queue     = std::make_unique<T_JOB[]>(Capacity);
+                m_Capacity  = Capacity;
+                m_Head      = 0;
+                m_Count     = 0;
+                m_nBusy     = 0;
+                m_pProcess  = pProcess;
+                m_pContext  = pContext;
+                m_bExit     = false;
+                m_Thread    = std::thread( [this]{ WorkerLoop(); } );
+            }
+
+            // Waits for all the pending jobs to be done and then kills the thread
+            void Stop( void ) noexcept
+            {
+                if ( m_Thread.joinable() == false ) return;
+
+                Flush();
+                {
+                    std::lock_guard Lock(m_Mutex);
+                    m_bExit = true;
+                }
+                m_NotEmpty.notify_all();
+                m_Thread.join();
+                m_Queue.reset();
+            }
+
+            [[nodiscard]] bool isRunning( void ) const noexcept
+            {
+                return m_Thread.joinable();
+            }
+
+            void Push( T_JOB&& Job ) noexcept
+            {
+                {
+                    std::unique_lock Lock(m_Mutex);
+                    m_NotFull.wait( Lock, [this]{ return m_Count < m_Capacity; } );
+                    m_Queue[(m_Head + m_Count) % m_Capacity] = std::move(Job);
+                    ++m_Count;
+                }
+                m_NotEmpty.notify_one();
+            }
+
+            [[nodiscard]] bool TryPush( T_JOB&& Job ) noexcept
+            {
+                {
+                    std::lock_guard Lock(m_Mutex);
+                    if ( m_Count == m_Capacity ) return false;
+                    m_Queue[(m_Head + m_Count) % m_Capacity] = std::move(Job);
+                    ++m_Count;
+                }
+                m_NotEmpty.notify_one();
+                return true;
+            }
+
+            // Blocks until the queue is empty and the worker is not processing anything
+            void Flush( void ) noexcept
+            {
+                if ( m_Thread.joinable() == false ) return;
+
+                std::unique_lock Lock(m_Mutex);
+                m_Idle.wait( Lock, [this]{ return m_Count == 0 && m_nBusy == 0; } );
+            }
+
+        protected:
+
+            void WorkerLoop( void ) noexcept
+            {
+                std::unique_lock Lock(m_Mutex);
+                while(true)
+                {
+                    m_NotEmpty.wait( Lock, [this]{ return m_Count > 0 || m_bExit; } );
+                    if ( m_Count == 0 ) return;
+
+                    T_JOB Job = std::move(m_Queue[m_Head]);
+                    m_Head = (m_Head + 1) % m_Capacity;
+                    --m_Count;
+                    ++m_nBusy;
+                    Lock.unlock();
+                    m_NotFull.notify_one();
+
+                    m_pProcess( m_pContext, Job );
+
+                    Lock.lock();
+                    --m_nBusy;
+                    if ( m_Count == 0 ) m_Idle.notify_all();
+                }
+            }
+
+            std::mutex                      m_Mutex     = {};
+            std::condition_variable         m_NotEmpty  = {};
+            std::condition_variable         m_NotFull   = {};
+            std::condition_variable         m_Idle      = {};
+            std::unique_ptr<T_JOB[]>        m_Queue     = {};
+            std::size_t                     m_Capacity  = 0;
+            std::size_t                     m_Head      = 0;
+            std::size_t                     m_Count     = 0;
+            int                             m_nBusy     = 0;
+            process_fn*                     m_pProcess  = { nullptr };
+            void*                           m_pContext  = { nullptr };
+            bool                            m_bExit     = { false };
+            std::thread                     m_Thread    = {};
         };
 
         //template< type_guid TYPE_GUID_V, typename = void > struct get_custom_name                                                                     { static inline           const char* value = []{return typeid(loader<TYPE_GUID_V>::data_type).name(); }(); };
         //template< type_guid TYPE_GUID_V >                  struct get_custom_name< TYPE_GUID_V, std::void_t< typename loader<TYPE_GUID_V>::name_v > > { static inline constexpr const char* value = loader<TYPE_GUID_V>::name_v; };
     }
 
+    namespace details
+    {
+        // Loaders opt into the progressive loading by setting use_progressive_v to true
+        template< typename T_LOADER >
+        concept progressive_loader = requires { T_LOADER::use_progressive_v; } && bool( T_LOADER::use_progressive_v );
+    }
+
     //
     // Registering a loader for a resource type
     //
@@ -95,6 +271,233 @@ namespace xresource
         {
             return loader::use_death_march_v;
         }
+
+        [[nodiscard]] constexpr bool hasBackgroundDestructionOn() const override
+        {
+            if constexpr ( requires { loader::use_background_destruction_v; } ) return loader::use_background_destruction_v;
+            else                                                                  return false;
+        }
+
+        [[nodiscard]] constexpr bool hasProgressiveOn() const override
+        {
+            return is_progressive_v;
+        }
+
+        [[nodiscard]] constexpr int getLevelCount( const void* pData ) const override
+        {
+            if constexpr ( is_progressive_v ) return loader::getLevelCount( *static_cast<const type*>(pData) );
+            else                              return 1;
+        }
+
+        [[nodiscard]] constexpr std::size_t getLevelSize( const void* pData, int Level ) const override
+        {
+            if constexpr ( is_progressive_v ) return loader::getLevelSize( *static_cast<const type*>(pData), Level );
+            else                              return 0;
+        }
+
+        [[nodiscard]] constexpr void* StreamLevel( xresource::mgr& Mgr, const void* pData, int Level, const full_guid& GUID ) const override
+        {
+            if constexpr ( is_progressive_v ) return loader::StreamLevel( Mgr, *static_cast<const type*>(pData), Level, GUID );
+            else                              return nullptr;
+        }
+
+        constexpr void CommitLevel( xresource::mgr& Mgr, void* pData, int Level, void* pStaging, const full_guid& GUID ) const override
+        {
+            if constexpr ( is_progressive_v ) loader::CommitLevel( Mgr, *static_cast<type*>(pData), Level, pStaging, GUID );
+        }
+
+        constexpr void DropLevel( xresource::mgr& Mgr, void* pData, int Level, const full_guid& GUID ) const override
+        {
+            if constexpr ( is_progressive_v ) loader::DropLevel( Mgr, *static_cast<type*>(pData), Level, GUID );
+        }
+
+        constexpr void DiscardLevel( xresource::mgr& Mgr, void* pData, int Level, void* pStaging, const full_guid& GUID ) const override
+        {
+            if constexpr ( is_progressive_v )
+            {
+                if constexpr ( requires { loader::DiscardLevel( Mgr, *static_cast<type*>(pData), Level, pStaging, GUID ); } ) loader::DiscardLevel( Mgr, *static_cast<type*>(pData), Level, pStaging, GUID );
+                else                                                                                                          loader::CommitLevel( Mgr, *static_cast<type*>(pData), Level, pStaging, GUID );
+            }
+        }
+
+    private:
+
+        inline static constexpr bool is_progressive_v = details::progressive_loader<loader>;
+    };
+
+    //
+    // RELOCATABLE BLOBS
+    //
+    // A blob resource is a single file which can be read in one go and used in place:
+    //      [blob_header][data...][fixup table]
+    // The data section starts with the root object (the loader data_type) and any pointers inside of it
+    // are blob_ptr which in the file hold an offset from the start of the data section. The fixup table
+    // has a blob_fixup for every non-null blob_ptr, relocating is a single linear pass.
+    // All the types stored in a blob must be trivially copyable and are stored little endian.
+    //
+    // Relocation checks that every pointer and the memory it points to (using the size and alignment recorded
+    // in its fixup) are inside the data section and aligned. This catches corrupt or truncated files, but the
+    // recorded size/alignment can not be checked against the C++ types, so blobs must come from a trusted builder.
+    //
+    inline static constexpr std::uint32_t   blob_magic_v        = 0x4C425258;   // "XRBL"
+    inline static constexpr std::uint16_t   blob_version_v      = 1;
+    inline static constexpr std::size_t     blob_alignment_v    = 16;
+
+    struct blob_header
+    {
+        std::uint32_t               m_Magic         = blob_magic_v;
+        std::uint16_t               m_Version       = blob_version_v;
+        std::uint16_t               m_Flags         = 0;
+        std::uint32_t               m_DataSize      = 0;            // Bytes in the data section
+        std::uint32_t               m_FixupCount    = 0;            // Entries in the fixup table which follows the data
+    };
+    static_assert( sizeof(blob_header) == blob_alignment_v, "The data must start aligned" );
+
+    struct blob_fixup
+    {
+        std::uint32_t               m_Location          = 0;        // Offset of the blob_ptr in the data section
+        std::uint32_t               m_TargetSize        = 0;        // Bytes that the pointer can access
+        std::uint32_t               m_TargetAlignment   = 1;        // Alignment of the type it points to
+    };
+    static_assert( sizeof(blob_fixup) == 3 * sizeof(std::uint32_t) );
+
+    template< typename T >
+    struct blob_ptr
+    {
+        union
+        {
+            std::uint64_t           m_Offset        = 0;            // In the file (and while building)
+            T*                      m_pValue;                       // After the blob has been relocated
+        };
+
+        [[nodiscard]] T*            get             ( void )                const noexcept { return m_pValue; }
+        [[nodiscard]] T*            operator ->     ( void )                const noexcept { return m_pValue; }
+        [[nodiscard]] T&            operator *      ( void )                const noexcept { return *m_pValue; }
+        [[nodiscard]] T&            operator []     ( std::size_t Index )   const noexcept { return m_pValue[Index]; }
+        [[nodiscard]] explicit      operator bool   ( void )                const noexcept { return m_pValue != nullptr; }
+    };
+    static_assert( sizeof(blob_ptr<int>) == sizeof(std::uint64_t) );
+
+    //
+    // Validates a blob which is already in memory (read or privately mapped) and patches all its pointers
+    // Returns the root object or nullptr if the blob is not valid
+    //
+    [[nodiscard]] inline void* RelocateBlob( std::span<std::byte> Blob ) noexcept
+    {
+        if ( Blob.size() < sizeof(blob_header) ) return nullptr;
+        if ( reinterpret_cast<std::uintptr_t>(Blob.data()) % blob_alignment_v ) return nullptr;
+
+        blob_header Header;
+        std::memcpy( &Header, Blob.data(), sizeof(Header) );
+
+        if ( Header.m_Magic != blob_magic_v || Header.m_Version != blob_version_v ) return nullptr;
+        if ( Blob.size() != sizeof(blob_header) + std::size_t{ Header.m_DataSize } + std::size_t{ Header.m_FixupCount } * sizeof(blob_fixup) ) return nullptr;
+
+        std::byte* const            pData   = Blob.data() + sizeof(blob_header);
+        const std::byte* const      pFixups = pData + Header.m_DataSize;
+
+        for ( std::uint32_t i = 0; i < Header.m_FixupCount; ++i )
+        {
+            blob_fixup Fixup;
+            std::memcpy( &Fixup, pFixups + i * sizeof(blob_fixup), sizeof(Fixup) );
+
+            // The pointer itself must be inside of the data
+            if ( Fixup.m_Location % alignof(std::uint64_t) || std::size_t{ Fixup.m_Location } + sizeof(std::uint64_t) > Header.m_DataSize ) return nullptr;
+
+            // The alignment must be a power of two which the data section can honor
+            if ( Fixup.m_TargetAlignment == 0 || (Fixup.m_TargetAlignment & (Fixup.m_TargetAlignment - 1)) || Fixup.m_TargetAlignment > blob_alignment_v ) return nullptr;
+
+            // And what it points to must be aligned and fully inside of the data
+            auto& Ptr = *reinterpret_cast<blob_ptr<std::byte>*>( pData + Fixup.m_Location );
+            if ( Ptr.m_Offset % Fixup.m_TargetAlignment ) return nullptr;
+            if ( Ptr.m_Offset > Header.m_DataSize || Fixup.m_TargetSize > Header.m_DataSize - Ptr.m_Offset ) return nullptr;
+
+            Ptr.m_pValue = pData + Ptr.m_Offset;
+        }
+
+        return pData;
+    }
+
+    //
+    // Tool side helper to create blobs
+    //      auto Root = Builder.Allocate<my_data>();
+    //      auto Keys = Builder.Allocate<float>(Count);
+    //      Builder.LinkPointer<float>( Root + offsetof(my_data, m_pKeys), Keys, Count );
+    //      auto File = Builder.Build();
+    //
+    struct blob_builder
+    {
+        // Returns the offset of the new zero initialized entries. The first allocation is the root
+        template< typename T >
+        std::uint32_t Allocate( std::size_t Count = 1 ) noexcept
+        {
+            static_assert( std::is_trivially_copyable_v<T>, "Blobs are used in place, they can not run constructors" );
+            static_assert( alignof(T) <= blob_alignment_v );
+
+            const std::size_t Offset = (m_Data.size() + alignof(T) - 1) & ~(alignof(T) - 1);
+            m_Data.resize( Offset + sizeof(T) * Count );
+            return static_cast<std::uint32_t>(Offset);
+        }
+
+        // Note that the reference becomes invalid after the next Allocate
+        template< typename T >
+        T& get( std::uint32_t Offset ) noexcept
+        {
+            assert( Offset + sizeof(T) <= m_Data.size() );
+            return *reinterpret_cast<T*>( &m_Data[Offset] );
+        }
+
+        // Makes the blob_ptr<T> located at PointerOffset point to the Count entries of T at TargetOffset
+        template< typename T >
+        void LinkPointer( std::uint32_t PointerOffset, std::uint32_t TargetOffset, std::size_t Count = 1 ) noexcept
+        {
+            assert( PointerOffset % alignof(std::uint64_t) == 0 );
+            assert( PointerOffset + sizeof(std::uint64_t) <= m_Data.size() );
+            assert( TargetOffset % alignof(T) == 0 );
+            assert( TargetOffset + sizeof(T) * Count <= m_Data.size() );
+
+            get<blob_ptr<T>>(PointerOffset).m_Offset = TargetOffset;
+            m_Fixups.push_back( blob_fixup{ PointerOffset, static_cast<std::uint32_t>(sizeof(T) * Count), static_cast<std::uint32_t>(alignof(T)) } );
+        }
+
+        // Returns the final file image
+        std::vector<std::byte> Build( void ) const noexcept
+        {
+            blob_header Header;
+            Header.m_DataSize   = static_cast<std::uint32_t>( (m_Data.size() + blob_alignment_v - 1) & ~(blob_alignment_v - 1) );
+            Header.m_FixupCount = static_cast<std::uint32_t>( m_Fixups.size() );
+
+            std::vector<std::byte> File( sizeof(Header) + Header.m_DataSize + m_Fixups.size() * sizeof(blob_fixup) );
+            std::memcpy( File.data(), &Header, sizeof(Header) );
+            if ( m_Data.empty() == false ) std::memcpy( File.data() + sizeof(Header), m_Data.data(), m_Data.size() );
+            if ( m_Fixups.empty() == false ) std::memcpy( File.data() + sizeof(Header) + Header.m_DataSize, m_Fixups.data(), m_Fixups.size() * sizeof(blob_fixup) );
+            return File;
+        }
+
+    protected:
+
+        std::vector<std::byte>      m_Data      = {};
+        std::vector<blob_fixup>     m_Fixups    = {};
+    };
+
+    //
+    // WEAK REFERENCES
+    // They watch a resource without keeping it alive. They are just the slot of the resource in the manager
+    // plus the generation of the slot, so once the resource is released (and the slot reused) they stop working
+    //
+    struct weak_ref
+    {
+        std::uint32_t               m_Index         = 0;
+        std::uint32_t               m_Generation    = 0;            // Zero means the reference is empty
+
+        [[nodiscard]] constexpr bool isValid( void ) const noexcept { return m_Generation != 0; }
+        constexpr bool operator == ( const weak_ref& ) const noexcept = default;
+    };
+
+    template< type_guid TYPE_GUID_V >
+    struct def_weak_ref : weak_ref
+    {
+        inline static constexpr auto m_Type = TYPE_GUID_V;
     };
 
     //
@@ -104,9 +507,19 @@ namespace xresource
     {
         struct instance_info
         {
-            void*                       m_pData     = { nullptr };
-            full_guid                   m_Guid      = {};
-            int                         m_RefCount  = { 1 };
+            void*                       m_pData         = { nullptr };
+            full_guid                   m_Guid          = {};
+            int                         m_RefCount      = { 1 };
+            std::uint32_t               m_Generation    = { 1 };        // Bumped every time the slot is released, used by the weak references
+            int                         m_LastUsedFrame = { 0 };
+
+            //--- Progressive resources only ---
+            int                         m_ProgressiveIndex  = { -1 };   // Index in the manager progressive list
+            int                         m_LevelCount        = { 0 };
+            int                         m_ResidentLevels    = { 0 };
+            std::size_t                 m_StreamedBytes     = { 0 };    // Memory of the resident levels above level 0
+            bool                        m_bStreaming        = { false };    // A level is in flight, the resource can not be destroyed until it arrives
+            bool                        m_bReleasePending   = { false };    // The user released it while streaming, it will be destroyed when the level arrives
         };
 
         struct universal_type
@@ -115,14 +528,168 @@ namespace xresource
             details::registration_base* m_pRegistration;
             std::wstring_view           m_TypeName;
             bool                        m_bUseDeathMarch;
+            bool                        m_bUseBackgroundDestruction;
+            bool                        m_bProgressive;
+            std::string                 m_TypeNameUTF8              = {};
+
+        #if !defined(_WIN32)
+            // Cached directory handle of "Root/Type", resources are open relative to it
+            int                         m_DirectoryFD               = -1;
+        #endif
+        };
+
+    #if !defined(_WIN32)
+        // One cached handle of a "Root/Type/XX/YY" bucket directory
+        struct bucket_directory
+        {
+            type_guid                   m_TypeGUID  = {};
+            std::uint16_t               m_Bucket    = 0;            // 0xYYXX
+            int                         m_FD        = -1;
+            std::uint64_t               m_LastUse   = 0;
+        };
+    #endif
+
+        #if defined(_WIN32)
+            inline static constexpr char    path_separator_v        = '\\';
+            inline static constexpr wchar_t path_separator_wide_v   = L'\\';
+        #else
+            inline static constexpr char    path_separator_v        = '/';
+            inline static constexpr wchar_t path_separator_wide_v   = L'/';
+        #endif
+
+        // Converts the wide strings (type names, root path) to UTF8 once so that paths can be built without allocations
+        inline std::string ToUTF8( std::wstring_view Wide ) noexcept
+        {
+            std::string Out;
+            Out.reserve(Wide.size());
+            for ( std::size_t i = 0; i < Wide.size(); ++i )
+            {
+                std::uint32_t C = static_cast<std::uint32_t>(Wide[i]);
+
+                // Windows wchar_t is UTF16 so merge the surrogate pairs
+                if constexpr (sizeof(wchar_t) == 2)
+                {
+                    if ( C >= 0xD800 && C <= 0xDBFF && (i + 1) < Wide.size() )
+                    {
+                        const std::uint32_t L = static_cast<std::uint32_t>(Wide[i + 1]);
+                        if ( L >= 0xDC00 && L <= 0xDFFF )
+                        {
+                            C = 0x10000 + ((C - 0xD800) << 10) + (L - 0xDC00);
+                            ++i;
+                        }
+                    }
+                }
+
+                if      ( C < 0x80 )    { Out.push_back( static_cast<char>(C) ); }
+                else if ( C < 0x800 )   { Out.push_back( static_cast<char>(0xC0 | (C >> 6)) );
+                                          Out.push_back( static_cast<char>(0x80 | (C & 0x3F)) ); }
+                else if ( C < 0x10000 ) { Out.push_back( static_cast<char>(0xE0 | (C >> 12)) );
+                                          Out.push_back( static_cast<char>(0x80 | ((C >> 6) & 0x3F)) );
+                                          Out.push_back( static_cast<char>(0x80 | (C & 0x3F)) ); }
+                else                    { Out.push_back( static_cast<char>(0xF0 | (C >> 18)) );
+                                          Out.push_back( static_cast<char>(0x80 | ((C >> 12) & 0x3F)) );
+                                          Out.push_back( static_cast<char>(0x80 | ((C >> 6) & 0x3F)) );
+                                          Out.push_back( static_cast<char>(0x80 | (C & 0x3F)) ); }
+            }
+            return Out;
+        }
+
+        //
+        // Writes a path into a user buffer without allocating. If the buffer is too small it remembers
+        // it and Finish will return 0
+        //
+        struct path_writer
+        {
+            char*   m_pCur;
+            char*   m_pEnd;
+            bool    m_bOverflow = { false };
+
+            explicit path_writer( std::span<char> Buffer ) noexcept
+                : m_pCur{ Buffer.data() }
+                , m_pEnd{ Buffer.data() + Buffer.size() }
+            {}
+
+            void Append( std::string_view Str ) noexcept
+            {
+                // Keep one character for the null terminator
+                if ( static_cast<std::size_t>(m_pEnd - m_pCur) <= Str.size() ) { m_bOverflow = true; return; }
+                for ( char C : Str ) *m_pCur++ = C;
+            }
+
+            void Separator( void ) noexcept
+            {
+                Append( std::string_view{ &path_separator_v, 1 } );
+            }
+
+            void AppendHex( std::uint64_t Value, int MinDigits ) noexcept
+            {
+                char Temp[16];
+                int  n = 0;
+                do
+                {
+                    Temp[n++] = "0123456789ABCDEF"[Value & 0xf];
+                    Value >>= 4;
+                } while ( Value || n < MinDigits );
+
+                char Digits[16];
+                for ( int i = 0; i < n; ++i ) Digits[i] = Temp[n - 1 - i];
+                Append( std::string_view{ Digits, static_cast<std::size_t>(n) } );
+            }
+
+            // The fan-out directories "XX/YY" are the first two bytes of the instance guid
+            void AppendBucket( std::uint64_t InstanceValue ) noexcept
+            {
+                AppendHex( (InstanceValue >> 0) & 0xff, 2 );
+                Separator();
+                AppendHex( (InstanceValue >> 8) & 0xff, 2 );
+            }
+
+            std::size_t Finish( char* pBegin ) noexcept
+            {
+                if ( m_bOverflow ) return 0;
+                *m_pCur = 0;
+                return static_cast<std::size_t>(m_pCur - pBegin);
+            }
+        };
+
+        struct destruction_job
+        {
+            registration_base*          m_pRegistration = { nullptr };
+            void*                       m_pData         = { nullptr };
+            full_guid                   m_FullGuid      = {};
+        };
+
+        struct progressive_entry
+        {
+            instance_info*              m_pInfo         = { nullptr };
+            registration_base*          m_pRegistration = { nullptr };
+        };
+
+        struct stream_job
+        {
+            progressive_entry           m_Entry         = {};
+            int                         m_Level         = 0;
+            std::size_t                 m_Size          = 0;
+            void*                       m_pStaging      = { nullptr };
         };
     }
 
+    // Maximum number of "Root/Type/XX/YY" directory handles the manager keeps open (POSIX only)
+    inline static constexpr std::size_t directory_cache_capacity_v = 32;
+
     // Resource Manager
     struct mgr
     {
         ~mgr()
         {
+            // Make sure all the loaders are done before the user data goes away
+            m_StreamingWorker.Stop();
+            CommitStreamedLevels( true );
+            DrainDeathMarch();
+            m_DestructionWorker.Stop();
+
+            CloseDirectoryCache();
+
             // If the user have give us ownership of the user data we must free it
             if ( m_bOwnsUserData && m_pUserData )
             {
@@ -132,8 +699,11 @@ namespace xresource
 
         //-------------------------------------------------------------------------
 
-        void Initiallize( std::size_t MaxResource = 1000 ) noexcept
+        void Initiallize( std::size_t MaxResource = 1000, std::size_t BackgroundDestructionQueueSize = 256, std::size_t StreamingQueueSize = 64 ) noexcept
         {
+            // Only this thread is allowed to use the manager
+            m_MainThreadID = std::this_thread::get_id();
+
             m_MaxResources = MaxResource;
 
             m_InfoBuffer = std::make_unique<details::instance_info[]>(m_MaxResources);
@@ -160,9 +730,41 @@ namespace xresource
 
             m_RegisteredTypes.reserve(TotalTypes);
 
+            bool bNeedsDestructionWorker = false;
             for (details::registration_base* p = details::registration_base::s_pHead; p; p = p->m_pNext)
             {
-                m_RegisteredTypes.emplace( p->getTypeGuid(), details::universal_type{ p->getTypeGuid(), p, p->getTypeName(), p->hasDeathmarchOn() } );
+                const bool bBackground = p->hasDeathmarchOn() && p->hasBackgroundDestructionOn();
+                m_RegisteredTypes.emplace( p->getTypeGuid(), details::universal_type{ p->getTypeGuid(), p, p->getTypeName(), p->hasDeathmarchOn(), bBackground, p->hasProgressiveOn(), details::ToUTF8(p->getTypeName()) } );
+                bNeedsDestructionWorker |= bBackground;
+                if ( p->hasProgressiveOn() ) m_nProgressiveTypes++;
+            }
+
+            //
+            // Only pay for the thread if some loader asked for it
+            //
+            if ( bNeedsDestructionWorker && m_DestructionWorker.isRunning() == false )
+            {
+                m_DestructionWorker.Start( BackgroundDestructionQueueSize, [](void* pContext, details::destruction_job& Job )
+                {
+                    Job.m_pRegistration->Destroy( *static_cast<mgr*>(pContext), Job.m_pData, Job.m_FullGuid );
+                }, this );
+            }
+
+            //
+            // The streaming thread only reads the levels, they are committed in OnEndFrameDelegate
+            //
+            if ( m_nProgressiveTypes && m_StreamingWorker.isRunning() == false )
+            {
+                m_StreamingWorker.Start( StreamingQueueSize, [](void* pContext, details::stream_job& Job )
+                {
+                    auto& Mgr  = *static_cast<mgr*>(pContext);
+                    auto& Info = *Job.m_Entry.m_pInfo;
+
+                    Job.m_pStaging = Job.m_Entry.m_pRegistration->StreamLevel( Mgr, Info.m_pData, Job.m_Level, Info.m_Guid );
+
+                    std::lock_guard Lock( Mgr.m_StreamingMutex );
+                    Mgr.m_StreamingDone.push_back( Job );
+                }, this );
             }
         }
 
@@ -186,6 +788,8 @@ namespace xresource
         template<auto RSC_TYPE_V>
         typename loader<RSC_TYPE_V>::data_type* RegisterResource(def_guid<RSC_TYPE_V>& Guid, loader<RSC_TYPE_V>::data_type* pRSC)
         {
+            assert(isMainThread());
+
             using data_type = typename loader<RSC_TYPE_V>::data_type;
 
             assert(Guid.m_Instance.isValid() && Guid.m_Instance.isPointer() == false);
@@ -206,6 +810,8 @@ namespace xresource
         template< auto RSC_TYPE_V >
         typename loader<RSC_TYPE_V>::data_type* getResource( def_guid<RSC_TYPE_V>& R ) noexcept
         {
+            assert(isMainThread());
+
             using data_type = typename loader<RSC_TYPE_V>::data_type;
 
             // If we already have the xresource return now
@@ -215,6 +821,7 @@ namespace xresource
             {
                 auto& E = *Entry->second;
                 E.m_RefCount++;
+                E.m_LastUsedFrame = m_CurrentFrame;
                 return reinterpret_cast<data_type*>(R.m_Instance.m_Pointer = E.m_pData);
             }
 
@@ -231,6 +838,8 @@ namespace xresource
 
         void* getResource( full_guid& URef ) noexcept
         {
+            assert(isMainThread());
+
             // If we already have the xresource return now
             if (URef.m_Instance.isPointer()) return URef.m_Instance.m_Pointer;
 
@@ -238,6 +847,7 @@ namespace xresource
             {
                 auto& E = *Entry->second;
                 E.m_RefCount++;
+                E.m_LastUsedFrame = m_CurrentFrame;
                 URef.m_Instance.m_Pointer = E.m_pData;
                 return URef.m_Instance.m_Pointer;
             }
@@ -259,6 +869,8 @@ namespace xresource
         template< auto RSC_TYPE_V >
         void ReleaseRef(def_guid<RSC_TYPE_V>& Ref ) noexcept
         {
+            assert(isMainThread());
+
             if (Ref.m_Instance.isValid() == false || false == Ref.m_Instance.isPointer() ) return;
 
             auto S = m_ResourceInstanceRelease.find(reinterpret_cast<std::uint64_t>(Ref.m_Instance.m_Pointer));
@@ -273,7 +885,11 @@ namespace xresource
             //
             // If this is the last reference release the xresource
             //
-            if( R.m_RefCount == 0 )
+            if( R.m_RefCount == 0 && R.m_bStreaming )
+            {
+                DeferRelease(R);
+            }
+            else if( R.m_RefCount == 0 )
             {
                 if (loader<RSC_TYPE_V>::use_death_march_v)
                 {
@@ -294,6 +910,8 @@ namespace xresource
 
         void ReleaseRef( full_guid& URef ) noexcept
         {
+            assert(isMainThread());
+
             if (URef.m_Instance.isValid() == false || false == URef.m_Instance.isPointer()) return;
 
             auto S = m_ResourceInstanceRelease.find(reinterpret_cast<std::uint64_t>(URef.m_Instance.m_Pointer));
@@ -308,7 +926,11 @@ namespace xresource
             //
             // If this is the last reference release the xresource
             //
-            if (R.m_RefCount == 0)
+            if (R.m_RefCount == 0 && R.m_bStreaming)
+            {
+                DeferRelease(R);
+            }
+            else if (R.m_RefCount == 0)
             {
                 auto UniversalType = m_RegisteredTypes.find(URef.m_Type);
                 assert(UniversalType != m_RegisteredTypes.end()); // Type was not registered
@@ -360,6 +982,8 @@ namespace xresource
         template<auto RSC_TYPE_V >
         void CloneRef( def_guid<RSC_TYPE_V>& Dest, const def_guid<RSC_TYPE_V>& Ref ) noexcept
         {
+            assert(isMainThread());
+
             if( Ref.isValid() && Ref.m_Instance.isPointer() )
             {
                 if (Dest.isValid() && Dest.m_Instance.isPointer())
@@ -384,6 +1008,8 @@ namespace xresource
 
         void CloneRef(full_guid& Dest, const full_guid& URef ) noexcept
         {
+            assert(isMainThread());
+
             if(URef.m_Instance.isValid() && URef.m_Instance.isPointer() )
             {
                 if (Dest.m_Instance.isValid() && Dest.m_Instance.isPointer())
@@ -407,70 +1033,581 @@ namespace xresource
 
         //-------------------------------------------------------------------------
 
-        int getResourceCount() const noexcept
+        // Creates a weak reference for a resource which is currently loaded (the reference can hold the pointer or the guid)
+        // If the resource is not loaded the weak reference will be empty
+        template< auto RSC_TYPE_V >
+        def_weak_ref<RSC_TYPE_V> getWeakRef( const def_guid<RSC_TYPE_V>& Ref ) const noexcept
         {
-            assert( m_ResourceInstance.size() == m_ResourceInstanceRelease.size() );
-            return static_cast<int>(m_ResourceInstance.size());
+            const full_guid          URef = Ref;
+            def_weak_ref<RSC_TYPE_V> Weak;
+            static_cast<weak_ref&>(Weak) = getWeakRef( URef );
+            return Weak;
         }
 
         //-------------------------------------------------------------------------
 
-        void setRootPath( std::wstring&& Path ) noexcept
+        weak_ref getWeakRef( const full_guid& URef ) const noexcept
         {
-            m_RootPath = std::move(Path);
+            if ( URef.m_Instance.isValid() == false ) return {};
+
+            const details::instance_info* pInfo = nullptr;
+            if ( URef.m_Instance.isPointer() )
+            {
+                auto S = m_ResourceInstanceRelease.find(reinterpret_cast<std::uint64_t>(URef.m_Instance.m_Pointer));
+                assert(S != m_ResourceInstanceRelease.end());
+                pInfo = S->second;
+            }
+            else
+            {
+                auto S = m_ResourceInstance.find(URef);
+                if ( S == m_ResourceInstance.end() ) return {};
+                pInfo = S->second;
+            }
+
+            return weak_ref{ static_cast<std::uint32_t>(pInfo - m_InfoBuffer.get()), pInfo->m_Generation };
         }
 
         //-------------------------------------------------------------------------
 
-        const std::wstring_view getRootPath( void ) const noexcept
+        // Checks if the resource is still alive, this is just a direct access to the slot (no hash lookups)
+        [[nodiscard]] bool isAlive( const weak_ref& Weak ) const noexcept
         {
-            return m_RootPath;
+            return Weak.isValid() && Weak.m_Index < m_MaxResources && m_InfoBuffer[Weak.m_Index].m_Generation == Weak.m_Generation;
         }
 
         //-------------------------------------------------------------------------
 
-        std::wstring getResourcePath( const xresource::full_guid& Guid, const std::wstring_view TypeName ) noexcept
+        // Upgrades the weak reference to a strong one (adds a reference), Ref will then hold the pointer
+        // and must be released with ReleaseRef as usual. Returns nullptr if the resource has been released
+        template< auto RSC_TYPE_V >
+        typename loader<RSC_TYPE_V>::data_type* LockWeakRef( def_guid<RSC_TYPE_V>& Ref, const def_weak_ref<RSC_TYPE_V>& Weak ) noexcept
         {
-            // Make sure we get a valid guid
-            assert(Guid.isValid() && Guid.m_Instance.isPointer() == false);
+            assert(isMainThread());
+
+            if ( isAlive(Weak) == false ) return nullptr;
+
+            auto& Info = m_InfoBuffer[Weak.m_Index];
+            assert(Info.m_Guid.m_Type == RSC_TYPE_V);
+
+            if ( Ref.m_Instance.isValid() && Ref.m_Instance.isPointer() )
+            {
+                if ( Ref.m_Instance.m_Pointer == Info.m_pData ) return static_cast<typename loader<RSC_TYPE_V>::data_type*>(Info.m_pData);
+                ReleaseRef(Ref);
+            }
 
-            return std::format(L"{}\\{}\\{:02X}\\{:02X}\\{:X}", m_RootPath, TypeName, (Guid.m_Instance.m_Value >> 0) & 0xff, (Guid.m_Instance.m_Value >> 8) & 0xff, Guid.m_Instance.m_Value);
+            ++Info.m_RefCount;
+            Info.m_LastUsedFrame = m_CurrentFrame;
+            Ref.m_Instance.m_Pointer = Info.m_pData;
+            return static_cast<typename loader<RSC_TYPE_V>::data_type*>(Info.m_pData);
         }
 
         //-------------------------------------------------------------------------
 
-        std::wstring getResourcePath(const xresource::full_guid& Guid ) noexcept
+        void* LockWeakRef( full_guid& URef, const weak_ref& Weak ) noexcept
         {
-            assert(Guid.isValid() && Guid.m_Instance.isPointer()==false);
+            assert(isMainThread());
 
-            auto UniversalType = m_RegisteredTypes.find(Guid.m_Type);
+            if ( isAlive(Weak) == false ) return nullptr;
 
-            // Type was not registered
-            assert(UniversalType != m_RegisteredTypes.end());
+            auto& Info = m_InfoBuffer[Weak.m_Index];
 
-            // get the final path
-            return getResourcePath( Guid, UniversalType->second.m_TypeName );
+            if ( URef.m_Instance.isValid() && URef.m_Instance.isPointer() )
+            {
+                if ( URef.m_Instance.m_Pointer == Info.m_pData ) return Info.m_pData;
+                ReleaseRef(URef);
+            }
+
+            ++Info.m_RefCount;
+            Info.m_LastUsedFrame      = m_CurrentFrame;
+            URef.m_Type               = Info.m_Guid.m_Type;
+            URef.m_Instance.m_Pointer = Info.m_pData;
+            return Info.m_pData;
         }
 
         //-------------------------------------------------------------------------
 
-        void OnEndFrameDelegate()
+        // Resources released while they had a level in flight are no longer counted (they are destroyed when the level arrives)
+        int getResourceCount() const noexcept
         {
-            m_CurrentFrame++;
-            auto& DeathMarch = m_DeathMarchList[m_CurrentFrame % m_DeathMarchList.size()];
-            for (auto& E : DeathMarch)
-            {
+            assert( m_ResourceInstance.size() == m_ResourceInstanceRelease.size() );
+            return static_cast<int>(m_ResourceInstance.size());
+        }
+
+        //-------------------------------------------------------------------------
+
+        void setRootPath( std::wstring&& Path ) noexcept
+        {
+            // Any cached directory handles point to the old root
+            CloseDirectoryCache();
+
+            m_RootPath      = std::move(Path);
+            m_RootPathUTF8  = details::ToUTF8(m_RootPath);
+        }
+
+        //-------------------------------------------------------------------------
+
+        const std::wstring_view getRootPath( void ) const noexcept
+        {
+            return m_RootPath;
+        }
+
+        //-------------------------------------------------------------------------
+
+        std::wstring getResourcePath( const xresource::full_guid& Guid, const std::wstring_view TypeName ) noexcept
+        {
+            // Make sure we get a valid guid
+            assert(Guid.isValid() && Guid.m_Instance.isPointer() == false);
+
+            // When there is no root path the path is relative to the working directory
+            constexpr auto S = details::path_separator_wide_v;
+            if ( m_RootPath.empty() ) return std::format(L"{}{}{:02X}{}{:02X}{}{:X}", TypeName, S, (Guid.m_Instance.m_Value >> 0) & 0xff, S, (Guid.m_Instance.m_Value >> 8) & 0xff, S, Guid.m_Instance.m_Value);
+            return std::format(L"{}{}{}{}{:02X}{}{:02X}{}{:X}", m_RootPath, S, TypeName, S, (Guid.m_Instance.m_Value >> 0) & 0xff, S, (Guid.m_Instance.m_Value >> 8) & 0xff, S, Guid.m_Instance.m_Value);
+        }
+
+        //-------------------------------------------------------------------------
+
+        std::wstring getResourcePath(const xresource::full_guid& Guid ) noexcept
+        {
+            assert(Guid.isValid() && Guid.m_Instance.isPointer()==false);
+
+            auto UniversalType = m_RegisteredTypes.find(Guid.m_Type);
+
+            // Type was not registered
+            assert(UniversalType != m_RegisteredTypes.end());
+
+            // get the final path
+            return getResourcePath( Guid, UniversalType->second.m_TypeName );
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Writes the UTF8 path of the resource using native separators into the user buffer (null terminated)
+        // This version does not allocate. It returns the length of the path or 0 if the buffer was too small
+        std::size_t getResourcePath( std::span<char> Buffer, const xresource::full_guid& Guid ) const noexcept
+        {
+            assert(Guid.isValid() && Guid.m_Instance.isPointer()==false);
+
+            auto UniversalType = m_RegisteredTypes.find(Guid.m_Type);
+
+            // Type was not registered
+            assert(UniversalType != m_RegisteredTypes.end());
+
+            // When there is no root path the path is relative to the working directory (same as OpenResource)
+            details::path_writer Writer{ Buffer };
+            if ( m_RootPathUTF8.empty() == false )
+            {
+                Writer.Append( m_RootPathUTF8 );
+                Writer.Separator();
+            }
+            Writer.Append( UniversalType->second.m_TypeNameUTF8 );
+            Writer.Separator();
+            Writer.AppendBucket( Guid.m_Instance.m_Value );
+            Writer.Separator();
+            Writer.AppendHex( Guid.m_Instance.m_Value, 1 );
+            return Writer.Finish( Buffer.data() );
+        }
+
+    #if !defined(_WIN32)
+
+        //-------------------------------------------------------------------------
+
+        // Returns a cached handle to the directory "Root/Type", or -1 if it does not exist
+        // The handle is owned by the manager. It can be called from the streaming thread (StreamLevel)
+        int getTypeDirectory( type_guid TypeGuid ) noexcept
+        {
+            std::lock_guard Lock( m_DirectoryMutex );
+            return getTypeDirectoryLocked( TypeGuid );
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Returns a cached handle to the bucket directory "Root/Type/XX/YY" of the resource, or -1 if it does not exist
+        // Only the last directory_cache_capacity_v buckets are kept open (LRU), so the handle is only valid
+        // until the next call which touches a different bucket. Use it right away, do not keep it
+        int getResourceDirectory( const xresource::full_guid& Guid ) noexcept
+        {
+            assert(Guid.isValid() && Guid.m_Instance.isPointer()==false);
+
+            std::lock_guard Lock( m_DirectoryMutex );
+            return getResourceDirectoryLocked( Guid );
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Opens the resource relative to its cached bucket directory handle (openat) so no path is walked again
+        // Returns a file descriptor which the caller must close, or -1 on failure
+        int OpenResource( const xresource::full_guid& Guid, int Flags = O_RDONLY ) noexcept
+        {
+            assert(Guid.isValid() && Guid.m_Instance.isPointer()==false);
+
+            char Buffer[24];
+            details::path_writer Writer{ Buffer };
+            Writer.AppendHex( Guid.m_Instance.m_Value, 1 );
+            if ( Writer.Finish( Buffer ) == 0 ) return -1;
+
+            // Keep the lock so the bucket handle can not be evicted by another thread while we use it
+            std::lock_guard Lock( m_DirectoryMutex );
+
+            const int DirFD = getResourceDirectoryLocked( Guid );
+            if ( DirFD == -1 ) return -1;
+
+            return ::openat( DirFD, Buffer, Flags | O_CLOEXEC );
+        }
+
+    #endif
+
+        //-------------------------------------------------------------------------
+
+        // Reads a relocatable blob resource with a single read into one allocation and relocates it
+        // The returned pointer is the root object of the blob, and it must be freed with DestroyBlob
+        // Returns nullptr if the file is missing or it is not a valid blob (same as a failed Load)
+        template< typename T >
+        [[nodiscard]] T* LoadBlob( const xresource::full_guid& Guid ) noexcept
+        {
+            static_assert( std::is_trivially_destructible_v<T>, "Blob data is freed without running destructors" );
+            static_assert( alignof(T) <= blob_alignment_v );
+
+            std::byte*  pBlob   = nullptr;
+            std::size_t Size    = 0;
+
+        #if defined(_WIN32)
+            std::FILE* pFile = _wfopen( getResourcePath(Guid).c_str(), L"rb" );
+            if ( pFile == nullptr ) return nullptr;
+
+            if ( std::fseek( pFile, 0, SEEK_END ) == 0 )
+            {
+                const long FileSize = std::ftell( pFile );
+                if ( FileSize > 0 && std::fseek( pFile, 0, SEEK_SET ) == 0 )
+                {
+                    Size  = static_cast<std::size_t>(FileSize);
+                    pBlob = static_cast<std::byte*>( ::operator new( Size, std::align_val_t{ blob_alignment_v }, std::nothrow ) );
+                    if ( pBlob && std::fread( pBlob, 1, Size, pFile ) != Size )
+                    {
+                        ::operator delete( pBlob, std::align_val_t{ blob_alignment_v } );
+                        pBlob = nullptr;
+                    }
+                }
+            }
+            std::fclose( pFile );
+        #else
+            const int FD = OpenResource( Guid );
+            if ( FD == -1 ) return nullptr;
+
+            struct stat Stat;
+            if ( ::fstat( FD, &Stat ) == 0 && Stat.st_size > 0 )
+            {
+                Size  = static_cast<std::size_t>(Stat.st_size);
+                pBlob = static_cast<std::byte*>( ::operator new( Size, std::align_val_t{ blob_alignment_v }, std::nothrow ) );
+
+                // A regular file should come in a single read, but read is allowed to return less
+                for ( std::size_t Done = 0; pBlob && Done < Size; )
+                {
+                    const auto n = ::read( FD, pBlob + Done, Size - Done );
+                    if ( n <= 0 )
+                    {
+                        ::operator delete( pBlob, std::align_val_t{ blob_alignment_v } );
+                        pBlob = nullptr;
+                        break;
+                    }
+                    Done += static_cast<std::size_t>(n);
+                }
+            }
+            ::close( FD );
+        #endif
+
+            if ( pBlob == nullptr ) return nullptr;
+
+            void* pRoot = RelocateBlob( std::span<std::byte>{ pBlob, Size } );
+            if ( pRoot == nullptr || reinterpret_cast<const blob_header*>(pBlob)->m_DataSize < sizeof(T) )
+            {
+                ::operator delete( pBlob, std::align_val_t{ blob_alignment_v } );
+                return nullptr;
+            }
+
+            return static_cast<T*>(pRoot);
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Frees a blob returned by LoadBlob
+        template< typename T >
+        void DestroyBlob( T& Root ) noexcept
+        {
+            auto* pBlob = reinterpret_cast<std::byte*>(&Root) - sizeof(blob_header);
+            assert( reinterpret_cast<const blob_header*>(pBlob)->m_Magic == blob_magic_v );
+            ::operator delete( pBlob, std::align_val_t{ blob_alignment_v } );
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Closes all the cached directory handles, they will be reopen on demand
+        void CloseDirectoryCache( void ) noexcept
+        {
+        #if !defined(_WIN32)
+            // The streaming thread may be opening files with these handles
+            m_StreamingWorker.Flush();
+
+            std::lock_guard Lock( m_DirectoryMutex );
+            for ( auto& E : m_BucketDirectories )
+            {
+                if ( E.m_FD != -1 ) ::close(E.m_FD);
+                E = {};
+            }
+
+            for ( auto& [TypeGuid, Type] : m_RegisteredTypes )
+            {
+                if ( Type.m_DirectoryFD != -1 ) ::close(Type.m_DirectoryFD);
+                Type.m_DirectoryFD = -1;
+            }
+
+            if ( m_RootFD != -1 ) ::close(m_RootFD);
+            m_RootFD = -1;
+        #endif
+        }
+
+        //-------------------------------------------------------------------------
+
+        void OnEndFrameDelegate()
+        {
+            assert(isMainThread());
+
+            m_CurrentFrame++;
+            DestroyDeathMarch( m_DeathMarchList[m_CurrentFrame % m_DeathMarchList.size()] );
+
+            if ( m_nProgressiveTypes ) UpdateStreaming();
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Progressive resources which are not used (getResource, LockWeakRef or this function) for this many frames
+        // will start dropping their high quality levels
+        void setStreamingIdleFrames( int nFrames ) noexcept
+        {
+            m_StreamingIdleFrames = nFrames;
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Maximum memory for all the streamed levels (level 0 is always resident and it is not counted)
+        void setStreamingBudget( std::size_t Bytes ) noexcept
+        {
+            m_StreamingBudget = Bytes;
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Memory of all the streamed levels which are resident or being loaded
+        [[nodiscard]] std::size_t getStreamingMemory( void ) const noexcept
+        {
+            return m_StreamingBytes;
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Tells the manager that the resource is been used this frame, this keeps the levels of progressive resources resident
+        // getResource only records it when it has to resolve the guid (or load), a reference that already holds the pointer
+        // is not tracked (so the fast path stays free). Code that keeps using the resource must call MarkUsed every frame
+        // This version is a direct slot access, prefer it over the full_guid version
+        void MarkUsed( const weak_ref& Weak ) noexcept
+        {
+            assert(isMainThread());
+
+            if ( isAlive(Weak) ) m_InfoBuffer[Weak.m_Index].m_LastUsedFrame = m_CurrentFrame;
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Same as above but it needs a hash lookup
+        void MarkUsed( const full_guid& URef ) noexcept
+        {
+            assert(isMainThread());
+
+            if ( URef.m_Instance.isValid() == false ) return;
+
+            if ( URef.m_Instance.isPointer() )
+            {
+                auto S = m_ResourceInstanceRelease.find(reinterpret_cast<std::uint64_t>(URef.m_Instance.m_Pointer));
+                assert(S != m_ResourceInstanceRelease.end());
+                S->second->m_LastUsedFrame = m_CurrentFrame;
+            }
+            else if ( auto S = m_ResourceInstance.find(URef); S != m_ResourceInstance.end() )
+            {
+                S->second->m_LastUsedFrame = m_CurrentFrame;
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Returns how many quality levels are resident for a loaded resource (1 for non progressive resources)
+        [[nodiscard]] int getResidentLevels( const weak_ref& Weak ) const noexcept
+        {
+            if ( isAlive(Weak) == false ) return 0;
+            const auto& Info = m_InfoBuffer[Weak.m_Index];
+            return Info.m_ProgressiveIndex == -1 ? 1 : Info.m_ResidentLevels;
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Waits for all the levels in flight and commits them
+        // Resources released while they had a level in flight are destroyed here (or in the next OnEndFrameDelegate)
+        void FlushStreaming( void ) noexcept
+        {
+            m_StreamingWorker.Flush();
+            CommitStreamedLevels();
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Waits until all the resources already sent to the background destruction thread have been destroyed
+        // Resources still in the death march are not touched, so it is safe to call at any time (such before a budget check)
+        void FlushBackgroundDestruction( void ) noexcept
+        {
+            assert(isMainThread());
+            m_DestructionWorker.Flush();
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Destroys everything waiting in the death march right now (without waiting for the frames to pass)
+        // and waits for the background destruction thread to finish. This is meant for shutdown (the manager
+        // destructor calls it), nothing (such the GPU) can be using those resources any more
+        void DrainDeathMarch( void ) noexcept
+        {
+            assert(isMainThread());
+
+            // Oldest frame first
+            for ( std::size_t i = 1; i <= m_DeathMarchList.size(); ++i )
+            {
+                DestroyDeathMarch( m_DeathMarchList[(m_CurrentFrame + i) % m_DeathMarchList.size()] );
+            }
+
+            m_DestructionWorker.Flush();
+        }
+
+    protected:
+
+        struct death_march_entry
+        {
+            void*                   m_pData;
+            xresource::full_guid    m_FullGuid;
+        };
+
+        //-------------------------------------------------------------------------
+
+        // The manager is not thread safe, this is used to catch calls from the worker threads (such a loader Destroy)
+        [[nodiscard]] bool isMainThread( void ) const noexcept
+        {
+            // Before Initiallize any thread is fine (the global instance may never be initialized)
+            return m_MainThreadID == std::thread::id{} || m_MainThreadID == std::this_thread::get_id();
+        }
+
+        //-------------------------------------------------------------------------
+
+    #if !defined(_WIN32)
+
+        // m_DirectoryMutex must be locked
+        int getTypeDirectoryLocked( type_guid TypeGuid ) noexcept
+        {
+            auto UniversalType = m_RegisteredTypes.find(TypeGuid);
+
+            // Type was not registered
+            assert(UniversalType != m_RegisteredTypes.end());
+
+            auto& Type = UniversalType->second;
+            if ( Type.m_DirectoryFD != -1 ) return Type.m_DirectoryFD;
+
+            //
+            // First time we see this type, open the chain of directories
+            //
+            if ( m_RootFD == -1 )
+            {
+                m_RootFD = ::open( m_RootPathUTF8.empty() ? "." : m_RootPathUTF8.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+                if ( m_RootFD == -1 ) return -1;
+            }
+
+            Type.m_DirectoryFD = ::openat( m_RootFD, Type.m_TypeNameUTF8.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+            return Type.m_DirectoryFD;
+        }
+
+        //-------------------------------------------------------------------------
+
+        // m_DirectoryMutex must be locked
+        int getResourceDirectoryLocked( const xresource::full_guid& Guid ) noexcept
+        {
+            const auto Bucket = static_cast<std::uint16_t>(Guid.m_Instance.m_Value & 0xffff);
+
+            //
+            // The cache is small so a linear search is all we need, remember the least recently used on the way
+            //
+            details::bucket_directory* pVictim = &m_BucketDirectories[0];
+            for ( auto& E : m_BucketDirectories )
+            {
+                if ( E.m_FD != -1 && E.m_Bucket == Bucket && E.m_TypeGUID == Guid.m_Type )
+                {
+                    E.m_LastUse = ++m_DirectoryUseCounter;
+                    return E.m_FD;
+                }
+
+                if ( pVictim->m_FD != -1 && (E.m_FD == -1 || E.m_LastUse < pVictim->m_LastUse) ) pVictim = &E;
+            }
+
+            const int TypeFD = getTypeDirectoryLocked( Guid.m_Type );
+            if ( TypeFD == -1 ) return -1;
+
+            char Buffer[8];
+            details::path_writer Writer{ Buffer };
+            Writer.AppendBucket( Guid.m_Instance.m_Value );
+            if ( Writer.Finish( Buffer ) == 0 ) return -1;
+
+            const int FD = ::openat( TypeFD, Buffer, O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+            if ( FD == -1 ) return -1;
+
+            if ( pVictim->m_FD != -1 ) ::close( pVictim->m_FD );
+            *pVictim = details::bucket_directory{ Guid.m_Type, Bucket, FD, ++m_DirectoryUseCounter };
+            return FD;
+        }
+
+    #endif
+
+        //-------------------------------------------------------------------------
+
+        // The last reference went away while a level is been streamed, to the user the resource is gone
+        // but the data must live until the level arrives (see CommitStreamedLevels)
+        void DeferRelease( details::instance_info& RscInfo ) noexcept
+        {
+            m_ResourceInstance.erase( RscInfo.m_Guid );
+            m_ResourceInstanceRelease.erase( reinterpret_cast<std::uint64_t>(RscInfo.m_pData) );
+
+            // Kill the weak references now
+            if ( ++RscInfo.m_Generation == 0 ) RscInfo.m_Generation = 1;
+
+            RscInfo.m_bReleasePending = true;
+        }
+
+        //-------------------------------------------------------------------------
+
+        void DestroyDeathMarch( std::vector<death_march_entry>& DeathMarch ) noexcept
+        {
+            for (auto& E : DeathMarch)
+            {
                 auto It = m_RegisteredTypes.find(E.m_FullGuid.m_Type);
                 if (It != m_RegisteredTypes.end())
                 {
-                    It->second.m_pRegistration->Destroy(*this, E.m_pData, E.m_FullGuid);
+                    // Heavy resources can ask to be destroyed in the worker thread
+                    // Note that Push will block here if the worker is falling behind
+                    if ( It->second.m_bUseBackgroundDestruction )
+                    {
+                        m_DestructionWorker.Push( details::destruction_job{ It->second.m_pRegistration, E.m_pData, E.m_FullGuid } );
+                    }
+                    else
+                    {
+                        It->second.m_pRegistration->Destroy(*this, E.m_pData, E.m_FullGuid);
+                    }
                 }
             }
             DeathMarch.clear();
         }
 
-    protected:
-
         //-------------------------------------------------------------------------
 
         details::instance_info& AllocRscInfo( void ) noexcept
@@ -488,6 +1625,9 @@ namespace xresource
 
         void ReleaseRscInfo(details::instance_info& RscInfo) noexcept
         {
+            // Any weak reference to this slot is now dead (zero is reserved for empty weak references)
+            if ( ++RscInfo.m_Generation == 0 ) RscInfo.m_Generation = 1;
+
             // Add this xresource info to the empty chain
             RscInfo.m_pData = m_pInfoBufferEmptyHead;
             m_pInfoBufferEmptyHead = &RscInfo;
@@ -499,31 +1639,207 @@ namespace xresource
         {
             auto& RscInfo = AllocRscInfo();
 
-            RscInfo.m_pData     = pRsc;
-            RscInfo.m_Guid      = GUID;
-            RscInfo.m_RefCount  = 1;
+            RscInfo.m_pData             = pRsc;
+            RscInfo.m_Guid              = GUID;
+            RscInfo.m_RefCount          = 1;
+            RscInfo.m_LastUsedFrame     = m_CurrentFrame;
+            RscInfo.m_ProgressiveIndex  = -1;
+            RscInfo.m_bReleasePending   = false;
 
             m_ResourceInstance.emplace(GUID, &RscInfo );
             m_ResourceInstanceRelease.emplace( reinterpret_cast<std::uint64_t>(pRsc), &RscInfo );
+
+            //
+            // Progressive resources start with only level 0, the rest will be streamed
+            //
+            if ( m_nProgressiveTypes )
+            {
+                auto UniversalType = m_RegisteredTypes.find(GUID.m_Type);
+                if ( UniversalType != m_RegisteredTypes.end() && UniversalType->second.m_bProgressive )
+                {
+                    RscInfo.m_LevelCount        = UniversalType->second.m_pRegistration->getLevelCount(pRsc);
+                    RscInfo.m_ResidentLevels    = 1;
+                    RscInfo.m_StreamedBytes     = 0;
+                    RscInfo.m_bStreaming        = false;
+                    RscInfo.m_ProgressiveIndex  = static_cast<int>(m_ProgressiveList.size());
+                    m_ProgressiveList.push_back( details::progressive_entry{ &RscInfo, UniversalType->second.m_pRegistration } );
+                }
+            }
         }
 
         //-------------------------------------------------------------------------
 
         void FullInstanceInfoRelease( details::instance_info& RscInfo ) noexcept
         {
-            // Release references in the hashs maps
-            m_ResourceInstance.erase( RscInfo.m_Guid );
-            m_ResourceInstanceRelease.erase( reinterpret_cast<std::uint64_t>(RscInfo.m_pData) );
+            // Release references in the hashs maps (DeferRelease already did it, and the guid may have been loaded again)
+            if ( RscInfo.m_bReleasePending == false )
+            {
+                m_ResourceInstance.erase( RscInfo.m_Guid );
+                m_ResourceInstanceRelease.erase( reinterpret_cast<std::uint64_t>(RscInfo.m_pData) );
+            }
+            RscInfo.m_bReleasePending = false;
+
+            // Remove it from the progressive list (swap with the last one)
+            if ( RscInfo.m_ProgressiveIndex != -1 )
+            {
+                // Resources with levels in flight are destroyed when the level arrives
+                assert( RscInfo.m_bStreaming == false );
+
+                m_StreamingBytes -= RscInfo.m_StreamedBytes;
+
+                auto& Entry = m_ProgressiveList[RscInfo.m_ProgressiveIndex];
+                Entry = m_ProgressiveList.back();
+                Entry.m_pInfo->m_ProgressiveIndex = RscInfo.m_ProgressiveIndex;
+                m_ProgressiveList.pop_back();
+                RscInfo.m_ProgressiveIndex = -1;
+            }
 
             // Add this xresource info to the empty chain
             ReleaseRscInfo(RscInfo);
         }
 
-        struct death_march_entry
+        //-------------------------------------------------------------------------
+
+        // Drops the highest resident level of a progressive resource
+        void DropTopLevel( details::progressive_entry& Entry ) noexcept
         {
-            void*                   m_pData;
-            xresource::full_guid    m_FullGuid;
-        };
+            auto& Info = *Entry.m_pInfo;
+            assert( Info.m_ResidentLevels > 1 && Info.m_bStreaming == false );
+
+            const int         Level = Info.m_ResidentLevels - 1;
+            const std::size_t Size  = Entry.m_pRegistration->getLevelSize( Info.m_pData, Level );
+
+            Entry.m_pRegistration->DropLevel( *this, Info.m_pData, Level, Info.m_Guid );
+            Info.m_ResidentLevels--;
+            Info.m_StreamedBytes -= Size;
+            m_StreamingBytes     -= Size;
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Gives the levels loaded by the streaming thread to their resources
+        // Levels of resources that are going away (released, or all of them when bDiscardAll) are discarded instead
+        void CommitStreamedLevels( bool bDiscardAll = false ) noexcept
+        {
+            {
+                std::lock_guard Lock( m_StreamingMutex );
+                std::swap( m_StreamingDone, m_StreamingCommit );
+            }
+
+            for ( auto& Job : m_StreamingCommit )
+            {
+                auto& Info = *Job.m_Entry.m_pInfo;
+
+                if ( Job.m_pStaging && (bDiscardAll || Info.m_bReleasePending) )
+                {
+                    Job.m_Entry.m_pRegistration->DiscardLevel( *this, Info.m_pData, Job.m_Level, Job.m_pStaging, Info.m_Guid );
+                    m_StreamingBytes -= Job.m_Size;
+                }
+                else if ( Job.m_pStaging )
+                {
+                    Job.m_Entry.m_pRegistration->CommitLevel( *this, Info.m_pData, Job.m_Level, Job.m_pStaging, Info.m_Guid );
+                    Info.m_ResidentLevels++;
+                    Info.m_StreamedBytes += Job.m_Size;
+                }
+                else
+                {
+                    // The level failed to load so we will not try the higher levels again
+                    m_StreamingBytes  -= Job.m_Size;
+                    Info.m_LevelCount  = Job.m_Level;
+                }
+                Info.m_bStreaming = false;
+
+                //
+                // The user released it while the level was in flight, we can destroy it now
+                //
+                if ( Info.m_bReleasePending )
+                {
+                    auto UniversalType = m_RegisteredTypes.find(Info.m_Guid.m_Type);
+                    assert(UniversalType != m_RegisteredTypes.end());
+
+                    if ( UniversalType->second.m_bUseDeathMarch )
+                    {
+                        auto& DestructionList = m_DeathMarchList[m_CurrentFrame % m_DeathMarchList.size()];
+                        DestructionList.emplace_back(Info.m_pData, Info.m_Guid);
+                    }
+                    else
+                    {
+                        UniversalType->second.m_pRegistration->Destroy(*this, Info.m_pData, Info.m_Guid);
+                    }
+                    FullInstanceInfoRelease(Info);
+                }
+            }
+            m_StreamingCommit.clear();
+        }
+
+        //-------------------------------------------------------------------------
+
+        void UpdateStreaming( void ) noexcept
+        {
+            CommitStreamedLevels();
+
+            //
+            // Drop the high levels of the resources that no one is using
+            //
+            for ( auto& Entry : m_ProgressiveList )
+            {
+                auto& Info = *Entry.m_pInfo;
+                if ( Info.m_bStreaming == false && Info.m_ResidentLevels > 1 && (m_CurrentFrame - Info.m_LastUsedFrame) > m_StreamingIdleFrames )
+                {
+                    DropTopLevel( Entry );
+                }
+            }
+
+            //
+            // If we are still over budget (the budget may have changed) drop from the least recently used
+            // Collect the candidates once and keep them in a heap ordered by their last use
+            //
+            if ( m_StreamingBytes > m_StreamingBudget )
+            {
+                m_TrimCandidates.clear();
+                for ( auto& Entry : m_ProgressiveList )
+                {
+                    if ( Entry.m_pInfo->m_bStreaming == false && Entry.m_pInfo->m_ResidentLevels > 1 ) m_TrimCandidates.push_back( &Entry );
+                }
+
+                constexpr auto NewerFirst = []( const details::progressive_entry* pA, const details::progressive_entry* pB )
+                {
+                    return pA->m_pInfo->m_LastUsedFrame > pB->m_pInfo->m_LastUsedFrame;
+                };
+                std::make_heap( m_TrimCandidates.begin(), m_TrimCandidates.end(), NewerFirst );
+
+                while ( m_StreamingBytes > m_StreamingBudget && m_TrimCandidates.empty() == false )
+                {
+                    std::pop_heap( m_TrimCandidates.begin(), m_TrimCandidates.end(), NewerFirst );
+                    auto& Entry = *m_TrimCandidates.back();
+                    m_TrimCandidates.pop_back();
+
+                    // It is still the oldest so keep dropping its levels while we need to
+                    while ( m_StreamingBytes > m_StreamingBudget && Entry.m_pInfo->m_ResidentLevels > 1 ) DropTopLevel( Entry );
+                }
+            }
+
+            //
+            // Request the next level of the resources which are been used
+            //
+            for ( auto& Entry : m_ProgressiveList )
+            {
+                auto& Info = *Entry.m_pInfo;
+                if ( Info.m_bStreaming || Info.m_ResidentLevels >= Info.m_LevelCount ) continue;
+                if ( (m_CurrentFrame - Info.m_LastUsedFrame) > m_StreamingIdleFrames ) continue;
+
+                const std::size_t Size = Entry.m_pRegistration->getLevelSize( Info.m_pData, Info.m_ResidentLevels );
+                if ( m_StreamingBytes + Size > m_StreamingBudget ) continue;
+
+                // The queue is full, try again next frame
+                if ( m_StreamingWorker.TryPush( details::stream_job{ Entry, Info.m_ResidentLevels, Size } ) == false ) break;
+
+                // Until the level arrives the resource can not be destroyed (see DeferRelease)
+                Info.m_bStreaming = true;
+                m_StreamingBytes += Size;
+            }
+        }
+
 
         //-------------------------------------------------------------------------
         //-------------------------------------------------------------------------
@@ -535,10 +1851,49 @@ namespace xresource
         std::unique_ptr<details::instance_info[]>                   m_InfoBuffer                = {};
         std::size_t                                                 m_MaxResources              = {};
         std::wstring                                                m_RootPath                  = {};
+        std::string                                                 m_RootPathUTF8              = {};
+    #if !defined(_WIN32)
+        int                                                         m_RootFD                    = -1;
+        std::mutex                                                  m_DirectoryMutex            = {};
+        std::array<details::bucket_directory, directory_cache_capacity_v> m_BucketDirectories     = {};
+        std::uint64_t                                               m_DirectoryUseCounter       = 0;
+    #endif
         std::array<std::vector<death_march_entry>,2>                m_DeathMarchList            = {};
         int                                                         m_CurrentFrame              = 0;
         void*                                                       m_pUserData                 = {};
         bool                                                        m_bOwnsUserData             = {false};
+        details::bounded_worker<details::destruction_job>           m_DestructionWorker         = {};
+        std::thread::id                                             m_MainThreadID              = {};
+        int                                                         m_nProgressiveTypes         = 0;
+        std::vector<details::progressive_entry>                     m_ProgressiveList           = {};
+        std::size_t                                                 m_StreamingBudget           = ~std::size_t{0};
+        std::size_t                                                 m_StreamingBytes            = 0;
+        int                                                         m_StreamingIdleFrames       = 60;
+        std::mutex                                                  m_StreamingMutex            = {};
+        std::vector<details::stream_job>                            m_StreamingDone             = {};
+        std::vector<details::stream_job>                            m_StreamingCommit           = {};
+        std::vector<details::progressive_entry*>                    m_TrimCandidates            = {};
+        details::bounded_worker<details::stream_job>                m_StreamingWorker           = {};
+    };
+
+    //
+    // Loaders of relocatable blobs can inherit the Load/Destroy from here, they only need to add
+    // the rest of the expected static parameters (type_name_v, use_death_march_v, ...)
+    //
+    template< typename T_DATA >
+    struct blob_loader
+    {
+        using data_type = T_DATA;
+
+        static data_type* Load( xresource::mgr& Mgr, const full_guid& GUID ) noexcept
+        {
+            return Mgr.LoadBlob<data_type>(GUID);
+        }
+
+        static void Destroy( xresource::mgr& Mgr, data_type&& Data, [[maybe_unused]] const full_guid& GUID ) noexcept
+        {
+            Mgr.DestroyBlob(Data);
+        }
     };
 
     //